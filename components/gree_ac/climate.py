@@ -1,15 +1,31 @@
 """Climate platform for Gree AC."""
+import logging
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import climate, uart, sensor, select, switch as switch_component
+from esphome.components import (
+    climate,
+    uart,
+    sensor,
+    select,
+    number,
+    switch as switch_component,
+)
 from esphome.const import (
     CONF_ID,
     CONF_SUPPORTED_PRESETS,
     CONF_SUPPORTED_SWING_MODES,
+    DEVICE_CLASS_FREQUENCY,
+    DEVICE_CLASS_TEMPERATURE,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_CELSIUS,
+    UNIT_HERTZ,
 )
 from esphome.components.climate import ClimatePreset, ClimateSwingMode
 from . import gree_ac_ns, GreeAC
 
+_LOGGER = logging.getLogger(__name__)
+
 # Configuration keys
 CONF_CURRENT_TEMPERATURE_SENSOR = "current_temperature_sensor"
 CONF_HORIZONTAL_SWING_SELECT = "horizontal_swing_select"
@@ -18,6 +34,17 @@ CONF_DISPLAY_SELECT = "display_select"
 CONF_PLASMA_SWITCH = "plasma_switch"
 CONF_SLEEP_SWITCH = "sleep_switch"
 CONF_XFAN_SWITCH = "xfan_switch"
+CONF_OUTDOOR_TEMPERATURE = "outdoor_temperature"
+CONF_COMPRESSOR_FREQUENCY = "compressor_frequency"
+CONF_ON_TIMER_NUMBER = "on_timer_number"
+CONF_OFF_TIMER_NUMBER = "off_timer_number"
+CONF_TX_GUARD_TIME = "tx_guard_time"
+CONF_RX_TASK = "rx_task"
+CONF_RX_TASK_CORE = "rx_task_core"
+CONF_ERROR_LOG_INTERVAL = "error_log_interval"
+CONF_ERROR_LOG_BURST = "error_log_burst"
+CONF_HISTORY_SIZE = "history_size"
+CONF_HISTORY_INTERVAL = "history_interval"
 
 # Swing options - must match C++ constants
 ALLOWED_CLIMATE_SWING_MODES = {
@@ -51,6 +78,49 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_PLASMA_SWITCH): cv.use_id(switch_component.Switch),
             cv.Optional(CONF_SLEEP_SWITCH): cv.use_id(switch_component.Switch),
             cv.Optional(CONF_XFAN_SWITCH): cv.use_id(switch_component.Switch),
+            # Optional extended telemetry (only on units sending extended frames).
+            # EXPERIMENTAL: the 0x33 frame layout is not confirmed yet.
+            cv.Optional(CONF_OUTDOOR_TEMPERATURE): sensor.sensor_schema(
+                unit_of_measurement=UNIT_CELSIUS,
+                accuracy_decimals=0,
+                device_class=DEVICE_CLASS_TEMPERATURE,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            cv.Optional(CONF_COMPRESSOR_FREQUENCY): sensor.sensor_schema(
+                unit_of_measurement=UNIT_HERTZ,
+                accuracy_decimals=0,
+                device_class=DEVICE_CLASS_FREQUENCY,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            # Optional timer numbers in minutes (schedule runs on the unit itself).
+            # EXPERIMENTAL: the timer byte layout is not confirmed yet, and
+            # changes are written to the unit.
+            # User-defined like the selects/switches; no entities or actions are
+            # created here, see README "Built-in Timers" for an API action.
+            cv.Optional(CONF_ON_TIMER_NUMBER): cv.use_id(number.Number),
+            cv.Optional(CONF_OFF_TIMER_NUMBER): cv.use_id(number.Number),
+            # Idle time after a unit report before we may transmit
+            cv.Optional(
+                CONF_TX_GUARD_TIME, default="20ms"
+            ): cv.positive_time_period_milliseconds,
+            # Framing and checksum verification in a dedicated FreeRTOS task
+            # (no default off ESP32, so only_on_esp32 only rejects explicit use)
+            cv.SplitDefault(CONF_RX_TASK, esp32=False): cv.All(
+                cv.boolean, cv.only_on_esp32
+            ),
+            cv.SplitDefault(CONF_RX_TASK_CORE, esp32=1): cv.All(
+                cv.int_range(min=0, max=1), cv.only_on_esp32
+            ),
+            # Protocol errors: summary interval and immediate lines allowed
+            cv.Optional(
+                CONF_ERROR_LOG_INTERVAL, default="60s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_ERROR_LOG_BURST, default=3): cv.int_range(min=0, max=255),
+            # Local delta-encoded state history (bytes of RAM, 0 disables)
+            cv.Optional(CONF_HISTORY_SIZE, default=0): cv.int_range(min=0, max=65535),
+            cv.Optional(
+                CONF_HISTORY_INTERVAL, default="60s"
+            ): cv.positive_time_period_milliseconds,
         }
     )
     .extend(cv.polling_component_schema("1s"))
@@ -70,6 +140,37 @@ async def to_code(config):
         sens = await cg.get_variable(config[CONF_CURRENT_TEMPERATURE_SENSOR])
         cg.add(var.set_current_temperature_sensor(sens))
 
+    # Extended telemetry sensors (experimental)
+    if CONF_OUTDOOR_TEMPERATURE in config or CONF_COMPRESSOR_FREQUENCY in config:
+        _LOGGER.warning(
+            "gree_ac: %s/%s are experimental, the extended frame layout is not "
+            "confirmed yet and values may be wrong on your unit",
+            CONF_OUTDOOR_TEMPERATURE,
+            CONF_COMPRESSOR_FREQUENCY,
+        )
+    if CONF_OUTDOOR_TEMPERATURE in config:
+        sens = await sensor.new_sensor(config[CONF_OUTDOOR_TEMPERATURE])
+        cg.add(var.set_outdoor_temperature_sensor(sens))
+
+    if CONF_COMPRESSOR_FREQUENCY in config:
+        sens = await sensor.new_sensor(config[CONF_COMPRESSOR_FREQUENCY])
+        cg.add(var.set_compressor_frequency_sensor(sens))
+
+    cg.add(var.set_tx_guard_time(config[CONF_TX_GUARD_TIME]))
+
+    cg.add(var.set_error_log_interval(config[CONF_ERROR_LOG_INTERVAL]))
+    cg.add(var.set_error_log_burst(config[CONF_ERROR_LOG_BURST]))
+
+    # Optional RX task (ESP32 only)
+    if config.get(CONF_RX_TASK):
+        cg.add(var.set_rx_task(True))
+        cg.add(var.set_rx_task_core(config[CONF_RX_TASK_CORE]))
+
+    # Optional state history
+    if config[CONF_HISTORY_SIZE] > 0:
+        cg.add(var.set_history_size(config[CONF_HISTORY_SIZE]))
+        cg.add(var.set_history_interval(config[CONF_HISTORY_INTERVAL]))
+
     # Supported presets
     if CONF_SUPPORTED_PRESETS in config:
         cg.add(var.set_supported_presets(config[CONF_SUPPORTED_PRESETS]))
@@ -104,3 +205,19 @@ async def to_code(config):
         sw = await cg.get_variable(config[CONF_XFAN_SWITCH])
         cg.add(var.set_xfan_switch(sw))
 
+    # Optional timer numbers (experimental)
+    if CONF_ON_TIMER_NUMBER in config or CONF_OFF_TIMER_NUMBER in config:
+        _LOGGER.warning(
+            "gree_ac: %s/%s are experimental, the timer byte layout is not "
+            "confirmed yet and timer commands are written to the unit",
+            CONF_ON_TIMER_NUMBER,
+            CONF_OFF_TIMER_NUMBER,
+        )
+
+    if CONF_ON_TIMER_NUMBER in config:
+        num = await cg.get_variable(config[CONF_ON_TIMER_NUMBER])
+        cg.add(var.set_on_timer_number(num))
+
+    if CONF_OFF_TIMER_NUMBER in config:
+        num = await cg.get_variable(config[CONF_OFF_TIMER_NUMBER])
+        cg.add(var.set_off_timer_number(num))
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace gree_ac {
+
+// Lock-free single-producer/single-consumer ring of fixed-size frame slots.
+//
+// Producer: fill the slot returned by acquire(), then publish it with commit().
+// Consumer: read the slot returned by front(), then release it with pop().
+// Only depends on <atomic> so it builds unchanged on the host (std::thread)
+// for stress testing.
+template<size_t SlotSize, size_t Depth> class FrameQueue {
+  static_assert(Depth > 0 && (Depth & (Depth - 1)) == 0, "Depth must be a power of two");
+
+ public:
+  struct Slot {
+    uint8_t size;
+    uint8_t status;  // Producer-defined, e.g. a verification result
+    uint8_t data[SlotSize];
+  };
+
+  // Producer side. Returns nullptr (and counts a drop) when the ring is full.
+  Slot *acquire() {
+    uint32_t head = this->head_.load(std::memory_order_relaxed);
+    if (head - this->tail_.load(std::memory_order_acquire) >= Depth) {
+      this->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    return &this->slots_[head & (Depth - 1)];
+  }
+  void commit() {
+    this->head_.store(this->head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  // Consumer side. Returns nullptr when the ring is empty.
+  const Slot *front() {
+    uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (this->head_.load(std::memory_order_acquire) == tail) {
+      return nullptr;
+    }
+    return &this->slots_[tail & (Depth - 1)];
+  }
+  void pop() {
+    this->tail_.store(this->tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  uint32_t get_dropped() const { return this->dropped_.load(std::memory_order_relaxed); }
+
+ protected:
+  Slot slots_[Depth];
+  std::atomic<uint32_t> head_{0};     // Written by producer only
+  std::atomic<uint32_t> tail_{0};     // Written by consumer only
+  std::atomic<uint32_t> dropped_{0};  // Written by producer only
+};
+
+}  // namespace gree_ac
+}  // namespace esphome
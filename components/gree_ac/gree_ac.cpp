@@ -1,12 +1,22 @@
 #include "gree_ac.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include <cmath>
+#include <cstring>
+
+#ifdef USE_NUMBER
+#include "esphome/components/number/number.h"
+#endif
+#ifdef USE_SELECT
+#include "esphome/components/select/select.h"
+#endif
 
 namespace esphome {
 namespace gree_ac {
 
 // Byte positions in packets
 static const uint8_t FORCE_UPDATE_BYTE = 7;
+static const uint8_t FORCE_UPDATE_VALUE = 175;
 static const uint8_t MODE_BYTE = 8;
 static const uint8_t MODE_MASK = 0xF0;
 static const uint8_t FAN_MASK = 0x0F;
@@ -20,29 +30,136 @@ static const uint8_t SLEEP_BYTE = 4;
 static const uint8_t SLEEP_MASK = 0x08;
 static const uint8_t XFAN_BYTE = 6;
 static const uint8_t XFAN_MASK = 0x08;
+// Experimental: timer bytes not yet confirmed against captures from real units
+static const uint8_t ON_TIMER_BYTE = 14;
+static const uint8_t OFF_TIMER_BYTE = 15;
 static const uint8_t INDOOR_TEMP_BYTE = 46;
 static const uint8_t CRC_BYTE = 46;
 
+// Byte positions in extended (CMD_IN_OUTDOOR_REPORT) frames. Experimental:
+// not yet confirmed against captures from real units.
+static const uint8_t OUTDOOR_TEMP_BYTE = 4;
+static const uint8_t COMPRESSOR_FREQ_BYTE = 5;
+
+// Command byte -> FRAME_HANDLERS slot. Slot 0 counts unknown frame types.
+struct FrameTypeIndex {
+  uint8_t slot[256];
+};
+
+static constexpr FrameTypeIndex build_frame_type_index() {
+  FrameTypeIndex index{};
+  index.slot[CMD_IN_UNIT_REPORT] = 1;
+  index.slot[CMD_IN_OUTDOOR_REPORT] = 2;
+  return index;
+}
+
+static constexpr FrameTypeIndex FRAME_TYPE_INDEX = build_frame_type_index();
+
+static constexpr uint64_t byte_bit(uint8_t index) { return 1ULL << index; }
+
+// Bit i is set when byte i differs from the previous frame of the same type.
+// No previous frame, or one of a different size, counts as fully changed.
+static uint64_t frame_change_mask(const uint8_t *prev, uint8_t prev_size, const uint8_t *data, uint8_t size) {
+  if (prev_size != size) {
+    return ~0ULL;
+  }
+  if (memcmp(prev, data, size) == 0) {
+    return 0;
+  }
+  uint64_t mask = 0;
+  for (uint8_t i = 0; i < size && i < 64; i++) {
+    if (prev[i] != data[i]) {
+      mask |= byte_bit(i);
+    }
+  }
+  return mask;
+}
+
+static const char *const PROTOCOL_ERROR_NAMES[] = {
+    "none", "packet", "checksum", "temperature", "mode", "fan", "swing",
+};
+
+static void format_frame(char *out, size_t out_size, const uint8_t *data, uint8_t size) {
+  size_t pos = 0;
+  out[0] = '\0';
+  for (uint8_t i = 0; i < size && pos + 4 <= out_size; i++) {
+    pos += snprintf(out + pos, out_size - pos, "%02X ", data[i]);
+  }
+}
+
+const GreeAC::FrameHandler GreeAC::FRAME_HANDLERS[] = {
+    &GreeAC::handle_unknown_frame_,
+    &GreeAC::handle_unit_report_,
+    &GreeAC::handle_outdoor_report_,
+};
+
 void GreeAC::setup() {
   ESP_LOGI(TAG, "Gree AC component v%s starting...", VERSION);
   this->last_handshake_attempt_ = millis();
   this->last_packet_sent_ = millis();
+  this->build_traits_();
   
   // Setup callbacks for optional components
   this->setup_select_callbacks_();
   this->setup_switch_callbacks_();
   
-  // Setup external temperature sensor callback if configured
+  // Setup external temperature sensor callback if configured. The value is
+  // published from loop() together with any report decoded in the same pass.
   if (this->current_temperature_sensor_ != nullptr) {
     this->current_temperature_sensor_->add_on_state_callback([this](float state) {
       this->current_temperature = state;
-      this->publish_state();
+      this->publish_pending_ = true;
+    });
+  }
+
+  if (this->history_size_ > 0 && !this->history_.init(this->history_size_)) {
+    ESP_LOGE(TAG, "Could not allocate %u bytes for state history", static_cast<unsigned>(this->history_size_));
+  }
+  this->last_history_sample_ = millis();
+  this->last_error_summary_ = millis();
+
+#ifdef USE_NUMBER
+  // Timer numbers: only user changes are sent, values echoed from unit reports are not
+  if (this->on_timer_number_ != nullptr) {
+    this->on_timer_number_->add_on_state_callback([this](float value) {
+      auto minutes = static_cast<uint16_t>(value);
+      if (minutes != this->on_timer_minutes_) {
+        this->set_on_timer(minutes);
+      }
+    });
+  }
+  if (this->off_timer_number_ != nullptr) {
+    this->off_timer_number_->add_on_state_callback([this](float value) {
+      auto minutes = static_cast<uint16_t>(value);
+      if (minutes != this->off_timer_minutes_) {
+        this->set_off_timer(minutes);
+      }
     });
   }
+#endif
+
+#ifdef USE_ESP32
+  if (this->rx_task_enabled_) {
+    BaseType_t core = this->rx_task_core_ < portNUM_PROCESSORS ? this->rx_task_core_ : portNUM_PROCESSORS - 1;
+    if (xTaskCreatePinnedToCore(GreeAC::rx_task_, "gree_ac_rx", RX_TASK_STACK_SIZE, this, RX_TASK_PRIORITY,
+                                &this->rx_task_handle_, core) != pdPASS) {
+      ESP_LOGE(TAG, "Failed to start RX task, falling back to loop() polling");
+      this->rx_task_handle_ = nullptr;
+    }
+  }
+#endif
 }
 
 void GreeAC::loop() {
+#ifdef USE_ESP32
+  if (this->rx_task_handle_ != nullptr) {
+    this->drain_rx_queue_();
+  } else {
+    this->read_uart_data_();
+  }
+#else
   this->read_uart_data_();
+#endif
   
   // Check if we need to retry handshake
   uint32_t now = millis();
@@ -50,30 +167,57 @@ void GreeAC::loop() {
     if (now - this->last_handshake_attempt_ >= HANDSHAKE_RETRY_INTERVAL_MS) {
       ESP_LOGD(TAG, "Retrying handshake...");
       this->last_handshake_attempt_ = now;
-      this->send_packet_();
+      this->request_send_();
     }
   }
   
   // Check for timeout (AC stopped responding)
   if (this->state_ == ACState::READY) {
-    if (now - this->last_packet_received_ >= PACKET_TIMEOUT_MS) {
+    if (this->rx_idle_ms_(now) >= PACKET_TIMEOUT_MS) {
       ESP_LOGW(TAG, "AC communication timeout, waiting for response...");
+      this->timeout_errors_++;
       this->state_ = ACState::INITIALIZING;
+      this->invalidate_reports_();
       this->mark_failed();
     }
   }
+
+  // Pending frames go out only in the idle gap after a unit report
+  if (this->update_state_ == UpdateState::UPDATE_PENDING && this->tx_window_open_(now)) {
+    this->send_packet_();
+  }
+
+  if (this->publish_pending_) {
+    this->publish_pending_ = false;
+    this->publish_state();
+  }
+
+  if (now - this->last_error_summary_ >= this->error_log_interval_) {
+    this->flush_error_summary_(now);
+  }
+
+  if (this->history_.is_enabled() && now - this->last_history_sample_ >= this->history_interval_) {
+    this->record_history_(now);
+  }
 }
 
 void GreeAC::update() {
-  // Periodic update - send current state
+  // Periodic update - queue current state for the next idle window
   if (this->state_ == ACState::READY) {
-    this->send_packet_();
+    this->request_send_();
   }
 }
 
 void GreeAC::dump_config() {
   ESP_LOGCONFIG(TAG, "Gree AC:");
   ESP_LOGCONFIG(TAG, "  Update interval: %u ms", this->get_update_interval());
+  ESP_LOGCONFIG(TAG, "  TX guard time: %u ms", this->tx_guard_time_);
+  ESP_LOGCONFIG(TAG, "  Error log: summary every %u ms, burst %u", this->error_log_interval_, this->error_log_burst_);
+#ifdef USE_ESP32
+  if (this->rx_task_handle_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  RX task: core %u", this->rx_task_core_);
+  }
+#endif
   this->check_uart_settings(4800, 1, uart::UART_CONFIG_PARITY_EVEN, 8);
   
   if (this->horizontal_swing_select_ != nullptr) {
@@ -94,10 +238,32 @@ void GreeAC::dump_config() {
   if (this->xfan_switch_ != nullptr) {
     ESP_LOGCONFIG(TAG, "  X-Fan: configured");
   }
+  // Experimental: CMD_IN_OUTDOOR_REPORT layout not confirmed against captures yet
+  LOG_SENSOR("  ", "Outdoor temperature (experimental)", this->outdoor_temperature_sensor_);
+  LOG_SENSOR("  ", "Compressor frequency (experimental)", this->compressor_frequency_sensor_);
+  if (this->history_.is_enabled()) {
+    ESP_LOGCONFIG(TAG, "  History: %u bytes, every %u ms", static_cast<unsigned>(this->history_.get_size()),
+                  this->history_interval_);
+  }
+  if (this->on_timer_number_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  On timer: configured (experimental)");
+  }
+  if (this->off_timer_number_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Off timer: configured (experimental)");
+  }
 }
 
 climate::ClimateTraits GreeAC::traits() {
-  auto traits = climate::ClimateTraits();
+  // Called on every publish_state(); the traits never change after setup()
+  if (!this->traits_built_) {
+    this->build_traits_();
+  }
+  return this->traits_;
+}
+
+void GreeAC::build_traits_() {
+  auto &traits = this->traits_;
+  traits = climate::ClimateTraits();
   
   // Add feature flags instead of deprecated setter (ESPHome 2025+)
   traits.add_feature_flags(climate::CLIMATE_SUPPORTS_CURRENT_TEMPERATURE);
@@ -113,11 +279,12 @@ climate::ClimateTraits GreeAC::traits() {
       climate::CLIMATE_MODE_FAN_ONLY,
       climate::CLIMATE_MODE_HEAT});
   
-  traits.set_supported_custom_fan_modes({
-      fan_modes::FAN_AUTO,
-      fan_modes::FAN_LOW,
-      fan_modes::FAN_MEDIUM,
-      fan_modes::FAN_HIGH});
+  // Standard fan modes: what parse/control actually use, and no strings per call
+  traits.set_supported_fan_modes({
+      climate::CLIMATE_FAN_AUTO,
+      climate::CLIMATE_FAN_LOW,
+      climate::CLIMATE_FAN_MEDIUM,
+      climate::CLIMATE_FAN_HIGH});
   
   // Add swing support
   traits.set_supported_swing_modes({
@@ -132,7 +299,7 @@ climate::ClimateTraits GreeAC::traits() {
   }
   traits.add_supported_preset(climate::CLIMATE_PRESET_NONE);
   
-  return traits;
+  this->traits_built_ = true;
 }
 
 void GreeAC::control(const climate::ClimateCall &call) {
@@ -144,7 +311,7 @@ void GreeAC::control(const climate::ClimateCall &call) {
   ESP_LOGD(TAG, "Control called");
 
   // Set force update byte to signal AC firmware
-  this->tx_buffer_[FORCE_UPDATE_BYTE] = 175;  // FORCE_UPDATE_VALUE from upstream
+  this->tx_buffer_[FORCE_UPDATE_BYTE] = FORCE_UPDATE_VALUE;
   // Show current temperature on display
   this->tx_buffer_[DISPLAY_BYTE] = 0x20;  // DISPLAY_SHOW_TEMP
 
@@ -269,77 +436,171 @@ void GreeAC::control(const climate::ClimateCall &call) {
   this->tx_buffer_[MODE_BYTE] = new_mode | new_fan_speed;
   this->mode = static_cast<climate::ClimateMode>(new_mode);  // Update internal state
 
-  // Compute CRC and send
-  uint8_t data_length = this->tx_buffer_[2];
-  uint16_t size = 3 + data_length;
-  if (size > GREE_TX_BUFFER_SIZE) size = GREE_TX_BUFFER_SIZE;
-  this->tx_buffer_[size - 1] = this->calculate_checksum_(this->tx_buffer_, size);
-  this->write_array(this->tx_buffer_, size);
-  this->packets_sent_++;
-  this->last_packet_sent_ = millis();
-  this->log_packet_(this->tx_buffer_, static_cast<uint8_t>(size), true);
+  // Local state was set optimistically; re-decode the next report in full
+  // so anything the unit didn't accept is reverted
+  this->invalidate_reports_();
 
-  // Reset force_update byte to "passive" state
-  this->tx_buffer_[FORCE_UPDATE_BYTE] = 0;
-  this->update_state_ = UpdateState::NO_UPDATE;
+  // CRC is computed and force_update reset when the frame actually goes out
+  this->request_send_();
 }
 
 void GreeAC::read_uart_data_() {
+  uint8_t frame_size;
   while (this->available()) {
     uint8_t byte;
     this->read_byte(&byte);
+    if (!this->frame_byte_(byte, frame_size)) {
+      continue;
+    }
+    ProtocolError error = this->verify_packet_(this->rx_buffer_, frame_size);
+    if (error == ProtocolError::NONE) {
+      this->handle_packet_(this->rx_buffer_, frame_size);
+    } else {
+      this->report_error_(error, this->rx_buffer_, frame_size);
+    }
+  }
+}
 
-    switch (this->serial_state_) {
-      case SerialState::WAIT_SYNC:
-        if (byte == GREE_START_BYTE) {
-          this->rx_buffer_[0] = byte;
-          this->rx_index_ = 1;
-          this->serial_state_ = SerialState::RECEIVE;
+bool GreeAC::frame_byte_(uint8_t byte, uint8_t &frame_size) {
+  // Feeds one received byte through the framer. Returns true when rx_buffer_
+  // holds a complete (not yet verified) frame of frame_size bytes.
+  bool complete = false;
+  switch (this->serial_state_) {
+    case SerialState::WAIT_SYNC:
+      if (byte == GREE_START_BYTE) {
+        // A report starting while our own frame is still on the wire is lost on this
+        // link. No logging here: this may run on the RX task.
+        if (static_cast<int32_t>(millis() - this->tx_busy_until_) < 0) {
+          this->tx_collisions_.fetch_add(1, std::memory_order_relaxed);
         }
+        this->rx_buffer_[0] = byte;
+        this->rx_index_ = 1;
+        this->serial_state_ = SerialState::RECEIVE;
+      }
+      break;
+
+    case SerialState::RECEIVE:
+      if (this->rx_index_ < GREE_RX_BUFFER_SIZE) {
+        this->rx_buffer_[this->rx_index_++] = byte;
+      } else {
+        // Buffer overflow: reset
+        this->serial_state_ = SerialState::WAIT_SYNC;
+        this->rx_index_ = 0;
         break;
+      }
 
-      case SerialState::RECEIVE:
-        if (this->rx_index_ < GREE_RX_BUFFER_SIZE) {
-          this->rx_buffer_[this->rx_index_++] = byte;
-        } else {
-          // Buffer overflow: reset
+      // Need at least 3 bytes to know full length: start,start,length
+      if (this->rx_index_ >= 3) {
+        uint8_t data_length = this->rx_buffer_[2];
+        uint16_t full_size = 3 + data_length; // header + data length
+        if (this->rx_index_ >= full_size) {
+          // Full packet received
+          frame_size = static_cast<uint8_t>(full_size);
+          complete = true;
+          // Reset for next packet
           this->serial_state_ = SerialState::WAIT_SYNC;
           this->rx_index_ = 0;
-          break;
         }
+      }
+      break;
 
-        // Need at least 3 bytes to know full length: start,start,length
-        if (this->rx_index_ >= 3) {
-          uint8_t data_length = this->rx_buffer_[2];
-          uint16_t full_size = 3 + data_length; // header + data length
-          if (this->rx_index_ >= full_size) {
-            // Full packet received
-            if (this->verify_packet_(this->rx_buffer_, full_size)) {
-              this->handle_packet_(this->rx_buffer_, full_size);
-            }
-            // Reset for next packet
-            this->serial_state_ = SerialState::WAIT_SYNC;
-            this->rx_index_ = 0;
-          }
-        }
-        break;
+    case SerialState::COMPLETE:
+    default:
+      this->serial_state_ = SerialState::WAIT_SYNC;
+      this->rx_index_ = 0;
+      break;
+  }
+  this->last_packet_received_ = millis();
+  return complete;
+}
 
-      case SerialState::COMPLETE:
-      default:
-        this->serial_state_ = SerialState::WAIT_SYNC;
-        this->rx_index_ = 0;
-        break;
+#ifdef USE_ESP32
+void GreeAC::rx_task_(void *arg) {
+  auto *self = static_cast<GreeAC *>(arg);
+  uint8_t frame_size;
+  while (true) {
+    while (self->available()) {
+      uint8_t byte;
+      self->read_byte(&byte);
+      if (!self->frame_byte_(byte, frame_size)) {
+        continue;
+      }
+      auto *slot = self->rx_queue_.acquire();
+      if (slot == nullptr) {
+        continue;  // loop() is behind; see get_rx_dropped_frames()
+      }
+      // Verified here, off the main loop; errors are reported from loop()
+      memcpy(slot->data, self->rx_buffer_, frame_size);
+      slot->size = frame_size;
+      slot->status = static_cast<uint8_t>(self->verify_packet_(slot->data, frame_size));
+      self->rx_queue_.commit();
+    }
+    vTaskDelay(pdMS_TO_TICKS(RX_TASK_POLL_MS));
+  }
+}
+
+void GreeAC::drain_rx_queue_() {
+  const auto *slot = this->rx_queue_.front();
+  while (slot != nullptr) {
+    auto error = static_cast<ProtocolError>(slot->status);
+    if (error == ProtocolError::NONE) {
+      this->handle_packet_(slot->data, slot->size);
+    } else {
+      this->report_error_(error, slot->data, slot->size);
     }
-    this->last_packet_received_ = millis();
+    this->rx_queue_.pop();
+    slot = this->rx_queue_.front();
   }
 }
+#endif
 
 void GreeAC::handle_packet_(const uint8_t *data, uint8_t size) {
-  // Parse the packet and update state. parse_state_packet_ decodes protocol fields
-  // and updates internal climate state.
-  this->parse_state_packet_(data, size);
+  // O(1) dispatch on the command byte; verify_packet_ guarantees size >= 4
+  (this->*FRAME_HANDLERS[FRAME_TYPE_INDEX.slot[data[3]]])(data, size);
+}
+
+void GreeAC::handle_unknown_frame_(const uint8_t * /*data*/, uint8_t /*size*/) {
+  // Well-formed but not decoded: count quietly, this is normal for some units
+  this->unknown_frames_++;
+}
+
+void GreeAC::handle_unit_report_(const uint8_t *data, uint8_t size) {
+  // Parse the packet and update state. parse_state_packet_ decodes only the
+  // fields whose bytes changed since the previous report.
+  uint64_t changed = frame_change_mask(this->last_report_, this->last_report_size_, data, size);
+  memcpy(this->last_report_, data, size);
+  this->last_report_size_ = size;
+  if (this->parse_state_packet_(data, size, changed)) {
+    this->publish_pending_ = true;
+  }
   this->state_ = ACState::READY;
-  this->publish_state();
+  this->command_in_flight_ = false;
+}
+
+void GreeAC::invalidate_reports_() {
+  this->last_report_size_ = 0;
+  this->last_outdoor_report_size_ = 0;
+}
+
+void GreeAC::handle_outdoor_report_(const uint8_t *data, uint8_t size) {
+  if (size <= COMPRESSOR_FREQ_BYTE + 1) {
+    this->report_error_(ProtocolError::PACKET, data, size);
+    return;
+  }
+  uint64_t changed = frame_change_mask(this->last_outdoor_report_, this->last_outdoor_report_size_, data, size);
+  if (changed == 0) {
+    return;
+  }
+  memcpy(this->last_outdoor_report_, data, size);
+  this->last_outdoor_report_size_ = size;
+
+  // Each sensor is decoded only if configured and its byte changed
+  if (this->outdoor_temperature_sensor_ != nullptr && (changed & byte_bit(OUTDOOR_TEMP_BYTE))) {
+    this->outdoor_temperature_sensor_->publish_state(static_cast<int8_t>(data[OUTDOOR_TEMP_BYTE]) - 40.0f);
+  }
+  if (this->compressor_frequency_sensor_ != nullptr && (changed & byte_bit(COMPRESSOR_FREQ_BYTE))) {
+    this->compressor_frequency_sensor_->publish_state(data[COMPRESSOR_FREQ_BYTE]);
+  }
 }
 
 // --- Small helper stubs required by header/linker ---
@@ -356,34 +617,91 @@ uint8_t GreeAC::calculate_checksum_(const uint8_t *message, size_t size) {
   return crc;
 }
 
-bool GreeAC::verify_packet_(const uint8_t *data, uint8_t size) {
-  // Minimal sanity checks
+ProtocolError GreeAC::verify_packet_(const uint8_t *data, uint8_t size) {
+  // No side effects: may run on the RX task
   if (size < 4) {
-    this->invalid_packet_errors_++;
-    ESP_LOGW(TAG, "Packet too small: %u", size);
-    return false;
+    return ProtocolError::PACKET;
   }
 
-  // Validate packet type (expect unit report / state)
-  if (data[3] != CMD_IN_UNIT_REPORT) {
-    this->invalid_packet_errors_++;
-    ESP_LOGW(TAG, "Invalid packet type. Expected: 0x%02X, Got: 0x%02X", CMD_IN_UNIT_REPORT, data[3]);
-    return false;
+  // Check checksum (last byte)
+  if (data[size - 1] != this->calculate_checksum_(data, size)) {
+    return ProtocolError::CHECKSUM;
   }
 
-  // Check checksum (last byte)
-  uint8_t received_crc = data[size - 1];
-  uint8_t calc = this->calculate_checksum_(data, size);
-  if (received_crc != calc) {
+  return ProtocolError::NONE;
+}
+
+void GreeAC::report_error_(ProtocolError error, const uint8_t *data, uint8_t size) {
+  if (error == ProtocolError::CHECKSUM) {
     this->checksum_errors_++;
-    ESP_LOGW(TAG, "Invalid checksum. Received: 0x%02X, Calculated: 0x%02X (errors: %u)", received_crc, calc, this->checksum_errors_);
-    return false;
+  } else if (error == ProtocolError::PACKET) {
+    this->invalid_packet_errors_++;
+  }
+  this->protocol_errors_++;
+  uint16_t &count = this->error_counts_[static_cast<uint8_t>(error)];
+  if (count < UINT16_MAX) {
+    count++;
+  }
+
+  if (this->first_error_ == ProtocolError::NONE) {
+    this->first_error_ = error;
+    this->first_error_size_ = size < GREE_RX_BUFFER_SIZE ? size : GREE_RX_BUFFER_SIZE;
+    memcpy(this->first_error_frame_, data, this->first_error_size_);
+  }
+
+  // A few errors are logged right away; the rest only show up in the summary
+  if (this->error_log_tokens_ == 0) {
+    if (this->errors_suppressed_ < UINT16_MAX) {
+      this->errors_suppressed_++;
+    }
+    return;
+  }
+  this->error_log_tokens_--;
+  char frame[GREE_RX_BUFFER_SIZE * 3 + 1];
+  format_frame(frame, sizeof(frame), data, size);
+  ESP_LOGW(TAG, "Protocol error: %s (frame: %s)", PROTOCOL_ERROR_NAMES[static_cast<uint8_t>(error)], frame);
+}
+
+void GreeAC::flush_error_summary_(uint32_t now) {
+#ifdef USE_ESP32
+  uint32_t dropped = this->rx_queue_.get_dropped();
+  if (dropped != this->rx_dropped_reported_) {
+    ESP_LOGW(TAG, "RX queue full, %u frames dropped (total %u)", dropped - this->rx_dropped_reported_, dropped);
+    this->rx_dropped_reported_ = dropped;
+  }
+#endif
+  if (this->first_error_ == ProtocolError::NONE) {
+    // Only an interval without any errors earns back an immediate line
+    if (this->error_log_tokens_ < this->error_log_burst_) {
+      this->error_log_tokens_++;
+    }
+    this->last_error_summary_ = now;
+    return;
   }
 
-  return true;
+  if (this->errors_suppressed_ > 0) {
+    char frame[GREE_RX_BUFFER_SIZE * 3 + 1];
+    format_frame(frame, sizeof(frame), this->first_error_frame_, this->first_error_size_);
+    ESP_LOGW(TAG,
+             "Protocol errors in last %us: packet=%u checksum=%u temperature=%u mode=%u fan=%u swing=%u "
+             "(%u not logged, total %u); first (%s): %s",
+             (now - this->last_error_summary_) / 1000, this->error_counts_[static_cast<uint8_t>(ProtocolError::PACKET)],
+             this->error_counts_[static_cast<uint8_t>(ProtocolError::CHECKSUM)],
+             this->error_counts_[static_cast<uint8_t>(ProtocolError::TEMPERATURE)],
+             this->error_counts_[static_cast<uint8_t>(ProtocolError::MODE)],
+             this->error_counts_[static_cast<uint8_t>(ProtocolError::FAN)],
+             this->error_counts_[static_cast<uint8_t>(ProtocolError::SWING)], this->errors_suppressed_,
+             this->protocol_errors_, PROTOCOL_ERROR_NAMES[static_cast<uint8_t>(this->first_error_)], frame);
+  }
+
+  memset(this->error_counts_, 0, sizeof(this->error_counts_));
+  this->errors_suppressed_ = 0;
+  this->first_error_ = ProtocolError::NONE;
+  this->last_error_summary_ = now;
 }
 
 void GreeAC::log_packet_(const uint8_t *message, uint8_t size, bool outgoing) {
+#if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
   const char *title = outgoing ? "Sent message" : "Received message";
   ESP_LOGV(TAG, "%s:", title);
   constexpr size_t MAX_STR_SIZE = 250;
@@ -397,108 +715,118 @@ void GreeAC::log_packet_(const uint8_t *message, uint8_t size, bool outgoing) {
     pstr += sprintf(pstr, "%02X ", message[i]);
   }
   ESP_LOGV(TAG, "%s", str);
+#else
+  (void) message;
+  (void) size;
+  (void) outgoing;
+#endif
 }
 
-void GreeAC::parse_state_packet_(const uint8_t *data, uint8_t size) {
+bool GreeAC::parse_state_packet_(const uint8_t *data, uint8_t size, uint64_t changed) {
   // Validate minimum packet size
   constexpr uint8_t MIN_PACKET_SIZE = sizeof(gree_header_t) + 1; // header + at least 1 data byte + CRC
   if (size < MIN_PACKET_SIZE + 1) {
-    ESP_LOGW(TAG, "Packet too small: size = %u, minimum = %u", size, MIN_PACKET_SIZE + 1);
-    return;
+    this->report_error_(ProtocolError::PACKET, data, size);
+    return false;
   }
 
-  // CRC check (last byte)
-  uint8_t data_crc = data[size - 1];
-  uint8_t calculated_crc = this->calculate_checksum_(data, size);
+  // Checksum was already verified by verify_packet_()
 
-  if (data_crc != calculated_crc) {
-    this->checksum_errors_++;
-    ESP_LOGW(TAG, "Invalid checksum. Received: 0x%02X, Calculated: 0x%02X (errors: %u)", data_crc, calculated_crc, this->checksum_errors_);
-    return;
+  // Validate bounds before accessing temperature
+  if (size <= TEMPERATURE_BYTE) {
+    this->report_error_(ProtocolError::PACKET, data, size);
+    return false;
   }
 
-  // Validate packet type (expect unit report / state)
-  if (size <= 3 || data[3] != CMD_IN_UNIT_REPORT) {
-    this->invalid_packet_errors_++;
-    ESP_LOGW(TAG, "Invalid packet type. Expected: 0x%02X, Got: 0x%02X (errors: %u)", CMD_IN_UNIT_REPORT, size > 3 ? data[3] : 0, this->invalid_packet_errors_);
-    return;
+  // Save some bytes into tx_buffer_ for subsequent commands, unless a command
+  // is still waiting for its TX window and would be overwritten
+  if (this->tx_buffer_[FORCE_UPDATE_BYTE] == 0) {
+    this->tx_buffer_[MODE_BYTE] = data[MODE_BYTE];
+    this->tx_buffer_[TEMPERATURE_BYTE] = data[TEMPERATURE_BYTE];
+    if (size > SWING_BYTE) {
+      this->tx_buffer_[SWING_BYTE] = data[SWING_BYTE];
+    }
   }
 
-  // Validate bounds before accessing temperature
-  if (size <= TEMPERATURE_BYTE) {
-    ESP_LOGW(TAG, "Packet too small to contain temperature data");
-    return;
-  }
+  // Everything below decodes a field only if its source bytes changed
+  bool state_changed = false;
 
   // Extract and validate target temperature
-  uint8_t temp_raw = data[TEMPERATURE_BYTE];
-  float target_temp = (temp_raw / 16.0f) + MIN_TEMPERATURE;
-  if (target_temp >= MIN_TEMPERATURE && target_temp <= MAX_TEMPERATURE) {
-    this->target_temperature = target_temp;
-  } else {
-    ESP_LOGW(TAG, "Invalid target temperature: %.1f (raw: 0x%02X)", target_temp, temp_raw);
+  if (changed & byte_bit(TEMPERATURE_BYTE)) {
+    uint8_t temp_raw = data[TEMPERATURE_BYTE];
+    float target_temp = (temp_raw / 16.0f) + MIN_TEMPERATURE;
+    if (target_temp >= MIN_TEMPERATURE && target_temp <= MAX_TEMPERATURE) {
+      this->target_temperature = target_temp;
+      state_changed = true;
+    } else {
+      this->report_error_(ProtocolError::TEMPERATURE, data, size);
+    }
   }
 
-  // Extract and validate current (indoor) temperature if present
-  if (size > INDOOR_TEMP_BYTE) {
+  // Extract and validate current (indoor) temperature, unless an external
+  // sensor provides it
+  if (size > INDOOR_TEMP_BYTE && this->current_temperature_sensor_ == nullptr &&
+      (changed & byte_bit(INDOOR_TEMP_BYTE))) {
     int8_t current_temp_raw = static_cast<int8_t>(data[INDOOR_TEMP_BYTE]);
     float current_temp = current_temp_raw - 40.0f;
     if (current_temp >= -10.0f && current_temp <= 50.0f) {
       this->current_temperature = current_temp;
+      state_changed = true;
     } else {
-      ESP_LOGW(TAG, "Invalid current temperature: %.1f (raw: 0x%02X)", current_temp, static_cast<uint8_t>(current_temp_raw));
+      this->report_error_(ProtocolError::TEMPERATURE, data, size);
     }
   }
 
-  // Save some bytes into tx_buffer_ for subsequent commands
-  this->tx_buffer_[MODE_BYTE] = data[MODE_BYTE];
-  this->tx_buffer_[TEMPERATURE_BYTE] = data[TEMPERATURE_BYTE];
+  if (changed & byte_bit(MODE_BYTE)) {
+    state_changed = true;
 
-  // Update climate mode
-  uint8_t mode_byte = data[MODE_BYTE];
-  switch (mode_byte & MODE_MASK) {
-    case static_cast<uint8_t>(ACMode::OFF):
-      this->mode = climate::CLIMATE_MODE_OFF;
-      break;
-    case static_cast<uint8_t>(ACMode::AUTO):
-      this->mode = climate::CLIMATE_MODE_AUTO;
-      break;
-    case static_cast<uint8_t>(ACMode::COOL):
-      this->mode = climate::CLIMATE_MODE_COOL;
-      break;
-    case static_cast<uint8_t>(ACMode::DRY):
-      this->mode = climate::CLIMATE_MODE_DRY;
-      break;
-    case static_cast<uint8_t>(ACMode::FAN_ONLY):
-      this->mode = climate::CLIMATE_MODE_FAN_ONLY;
-      break;
-    case static_cast<uint8_t>(ACMode::HEAT):
-      this->mode = climate::CLIMATE_MODE_HEAT;
-      break;
-    default:
-      ESP_LOGW(TAG, "Unknown AC MODE: 0x%02X", mode_byte & MODE_MASK);
-  }
+    // Update climate mode
+    uint8_t mode_byte = data[MODE_BYTE];
+    switch (mode_byte & MODE_MASK) {
+      case static_cast<uint8_t>(ACMode::OFF):
+        this->mode = climate::CLIMATE_MODE_OFF;
+        break;
+      case static_cast<uint8_t>(ACMode::AUTO):
+        this->mode = climate::CLIMATE_MODE_AUTO;
+        break;
+      case static_cast<uint8_t>(ACMode::COOL):
+        this->mode = climate::CLIMATE_MODE_COOL;
+        break;
+      case static_cast<uint8_t>(ACMode::DRY):
+        this->mode = climate::CLIMATE_MODE_DRY;
+        break;
+      case static_cast<uint8_t>(ACMode::FAN_ONLY):
+        this->mode = climate::CLIMATE_MODE_FAN_ONLY;
+        break;
+      case static_cast<uint8_t>(ACMode::HEAT):
+        this->mode = climate::CLIMATE_MODE_HEAT;
+        break;
+      default:
+        this->report_error_(ProtocolError::MODE, data, size);
+    }
 
-  // Update fan mode
-  switch (mode_byte & FAN_MASK) {
-    case static_cast<uint8_t>(ACFanSpeed::S_AUTO):
-      this->fan_mode = climate::CLIMATE_FAN_AUTO;
-      break;
-    case static_cast<uint8_t>(ACFanSpeed::S_LOW):
-      this->fan_mode = climate::CLIMATE_FAN_LOW;
-      break;
-    case static_cast<uint8_t>(ACFanSpeed::S_MEDIUM):
-      this->fan_mode = climate::CLIMATE_FAN_MEDIUM;
-      break;
-    case static_cast<uint8_t>(ACFanSpeed::S_HIGH):
-      this->fan_mode = climate::CLIMATE_FAN_HIGH;
-      break;
-    default:
-      ESP_LOGW(TAG, "Unknown AC FAN: 0x%02X", mode_byte & FAN_MASK);
+    // Update fan mode
+    switch (mode_byte & FAN_MASK) {
+      case static_cast<uint8_t>(ACFanSpeed::S_AUTO):
+        this->fan_mode = climate::CLIMATE_FAN_AUTO;
+        break;
+      case static_cast<uint8_t>(ACFanSpeed::S_LOW):
+        this->fan_mode = climate::CLIMATE_FAN_LOW;
+        break;
+      case static_cast<uint8_t>(ACFanSpeed::S_MEDIUM):
+        this->fan_mode = climate::CLIMATE_FAN_MEDIUM;
+        break;
+      case static_cast<uint8_t>(ACFanSpeed::S_HIGH):
+        this->fan_mode = climate::CLIMATE_FAN_HIGH;
+        break;
+      default:
+        this->report_error_(ProtocolError::FAN, data, size);
+    }
   }
 
   // Parse preset (boost mode)
-  if (size > PRESET_BYTE) {
+  if (size > PRESET_BYTE && (changed & byte_bit(PRESET_BYTE))) {
+    state_changed = true;
     uint8_t preset_byte = data[PRESET_BYTE];
     switch (preset_byte) {
       case PRESET_COOL_BOOST:
@@ -511,12 +839,13 @@ void GreeAC::parse_state_packet_(const uint8_t *data, uint8_t size) {
         this->preset = climate::CLIMATE_PRESET_NONE;
         break;
     }
-  } else {
+  } else if (size <= PRESET_BYTE) {
     this->preset = climate::CLIMATE_PRESET_NONE;
   }
 
   // Parse swing mode
-  if (size > SWING_BYTE) {
+  if (size > SWING_BYTE && (changed & byte_bit(SWING_BYTE))) {
+    state_changed = true;
     uint8_t swing_byte = data[SWING_BYTE];
     switch (swing_byte) {
       case AC_SWING_OFF:
@@ -532,29 +861,134 @@ void GreeAC::parse_state_packet_(const uint8_t *data, uint8_t size) {
         this->swing_mode = climate::CLIMATE_SWING_BOTH;
         break;
       default:
-        ESP_LOGW(TAG, "Unknown swing mode: 0x%02X", swing_byte);
+        this->report_error_(ProtocolError::SWING, data, size);
         break;
     }
-    // Save swing mode to write buffer for next command
-    this->tx_buffer_[SWING_BYTE] = swing_byte;
+  }
+
+  // Parse built-in timers (remaining time as counted down by the unit)
+  if (size > OFF_TIMER_BYTE && (changed & (byte_bit(ON_TIMER_BYTE) | byte_bit(OFF_TIMER_BYTE)))) {
+    this->on_timer_minutes_ = decode_timer_(data[ON_TIMER_BYTE]);
+    this->off_timer_minutes_ = decode_timer_(data[OFF_TIMER_BYTE]);
+#ifdef USE_NUMBER
+    if (this->on_timer_number_ != nullptr && this->on_timer_number_->state != this->on_timer_minutes_) {
+      this->on_timer_number_->publish_state(this->on_timer_minutes_);
+    }
+    if (this->off_timer_number_ != nullptr && this->off_timer_number_->state != this->off_timer_minutes_) {
+      this->off_timer_number_->publish_state(this->off_timer_minutes_);
+    }
+#endif
   }
 
   this->packets_received_++;
+  return state_changed;
 }
 
 void GreeAC::send_packet_() {
-  // Send a packet (used for handshake or periodic updates during READY state)
+  // Send a packet (used for handshake, periodic updates and control commands)
   uint8_t data_length = this->tx_buffer_[2];
   uint16_t size = 3 + data_length;
   if (size > GREE_TX_BUFFER_SIZE) size = GREE_TX_BUFFER_SIZE;
 
+  // Previous command never got a report back before this one
+  if (this->command_in_flight_) {
+    this->tx_ignored_commands_++;
+    ESP_LOGD(TAG, "Previous command got no response (ignored: %u)", this->tx_ignored_commands_);
+  }
+  this->command_in_flight_ = this->tx_buffer_[FORCE_UPDATE_BYTE] != 0;
+
   // Compute and fill CRC
   this->tx_buffer_[size - 1] = this->calculate_checksum_(this->tx_buffer_, size);
 
   this->write_array(this->tx_buffer_, size);
   this->packets_sent_++;
   this->last_packet_sent_ = millis();
+  this->tx_busy_until_ = this->last_packet_sent_ + (size * UART_BITS_PER_BYTE * 1000) / this->parent_->get_baud_rate() + 1;
   this->log_packet_(this->tx_buffer_, static_cast<uint8_t>(size), true);
+
+  // Reset force_update byte to "passive" state. Timer bytes only go out with
+  // the timer command itself, so later frames never re-arm a running timer.
+  this->tx_buffer_[FORCE_UPDATE_BYTE] = 0;
+  this->tx_buffer_[ON_TIMER_BYTE] = TIMER_UNCHANGED;
+  this->tx_buffer_[OFF_TIMER_BYTE] = TIMER_UNCHANGED;
+  this->update_state_ = UpdateState::NO_UPDATE;
+}
+
+void GreeAC::request_send_() {
+  if (this->update_state_ != UpdateState::UPDATE_PENDING) {
+    this->update_state_ = UpdateState::UPDATE_PENDING;
+    this->tx_pending_since_ = millis();
+  }
+}
+
+uint32_t GreeAC::rx_idle_ms_(uint32_t now) const {
+  // The RX task may have stamped a byte after the caller read `now`; that
+  // counts as no idle time rather than a wrapped ~49 day gap
+  uint32_t received = this->last_packet_received_.load(std::memory_order_relaxed);
+  int32_t idle = static_cast<int32_t>(now - received);
+  return idle > 0 ? static_cast<uint32_t>(idle) : 0;
+}
+
+bool GreeAC::tx_window_open_(uint32_t now) {
+  // Don't starve commands on a line that never goes quiet
+  if (now - this->tx_pending_since_ >= TX_MAX_DEFER_MS) {
+    return true;
+  }
+  // Unit is in the middle of its report
+  if (this->serial_state_ != SerialState::WAIT_SYNC) {
+    return false;
+  }
+  // Wait for the guard time after the last received byte
+  if (this->rx_idle_ms_(now) < this->tx_guard_time_) {
+    return false;
+  }
+  return now - this->last_packet_sent_ >= MIN_PACKET_INTERVAL_MS;
+}
+
+void GreeAC::set_on_timer(uint16_t minutes) {
+  ESP_LOGD(TAG, "Setting on timer: %u min", minutes);
+  this->send_timer_(ON_TIMER_BYTE, minutes);
+}
+
+void GreeAC::set_off_timer(uint16_t minutes) {
+  ESP_LOGD(TAG, "Setting off timer: %u min", minutes);
+  this->send_timer_(OFF_TIMER_BYTE, minutes);
+}
+
+void GreeAC::send_timer_(uint8_t timer_byte, uint16_t minutes) {
+  if (this->state_ != ACState::READY) {
+    ESP_LOGW(TAG, "AC not ready, ignoring timer request");
+    return;
+  }
+  // Only this timer's byte is set; the other stays TIMER_UNCHANGED unless an
+  // earlier call queued a value for it
+  this->tx_buffer_[timer_byte] = encode_timer_(minutes);
+  this->tx_buffer_[FORCE_UPDATE_BYTE] = FORCE_UPDATE_VALUE;
+  // Re-decode the next report so the timer numbers show what the unit accepted
+  this->invalidate_reports_();
+  this->request_send_();
+}
+
+uint8_t GreeAC::encode_timer_(uint16_t minutes) {
+  if (minutes == 0) {
+    return TIMER_CANCEL;
+  }
+  if (minutes > TIMER_MAX_MINUTES) {
+    minutes = TIMER_MAX_MINUTES;
+  }
+  // Round to the nearest step, but never down to "off"
+  uint8_t steps = static_cast<uint8_t>((minutes + TIMER_STEP_MINUTES / 2) / TIMER_STEP_MINUTES);
+  if (steps == 0) {
+    steps = 1;
+  }
+  return TIMER_ENABLE_MASK | (steps & TIMER_VALUE_MASK);
+}
+
+uint16_t GreeAC::decode_timer_(uint8_t timer_byte) {
+  if ((timer_byte & TIMER_ENABLE_MASK) == 0) {
+    return 0;
+  }
+  return (timer_byte & TIMER_VALUE_MASK) * TIMER_STEP_MINUTES;
 }
 
 void GreeAC::build_state_packet_() {
@@ -563,10 +997,22 @@ void GreeAC::build_state_packet_() {
 }
 
 void GreeAC::setup_select_callbacks_() {
-  // Optional select callbacks registered here will be wired by the generated code
-  // if select components are configured in YAML.
-  // The setters (set_horizontal_swing_select, etc.) assign the pointers,
-  // and this is called during setup() to establish the callback connections.
+  // Optional select callbacks, wired only if select components are configured
+  // in YAML. Only the option index is forwarded.
+#ifdef USE_SELECT
+  if (this->horizontal_swing_select_ != nullptr) {
+    this->horizontal_swing_select_->add_on_state_callback(
+        [this](const std::string &, size_t index) { this->on_horizontal_swing_change_(index); });
+  }
+  if (this->vertical_swing_select_ != nullptr) {
+    this->vertical_swing_select_->add_on_state_callback(
+        [this](const std::string &, size_t index) { this->on_vertical_swing_change_(index); });
+  }
+  if (this->display_select_ != nullptr) {
+    this->display_select_->add_on_state_callback(
+        [this](const std::string &, size_t index) { this->on_display_change_(index); });
+  }
+#endif
   ESP_LOGD(TAG, "Select callbacks setup (optional selects wired if present)");
 }
 
@@ -582,18 +1028,57 @@ void GreeAC::update_swing_states_() {
   // No-op placeholder for swing state update logic.
 }
 
-void GreeAC::on_horizontal_swing_change_(const std::string &value) {
-  ESP_LOGD(TAG, "Horizontal swing changed to: %s", value.c_str());
+void GreeAC::record_history_(uint32_t now) {
+  this->history_uptime_ms_ += now - this->last_history_sample_;
+  this->last_history_sample_ = now;
+  if (this->packets_received_ == 0) {
+    return;  // Nothing decoded yet
+  }
+
+  HistorySample sample;
+  sample.time_s = static_cast<uint32_t>(this->history_uptime_ms_ / 1000);
+  sample.mode = static_cast<uint8_t>(this->mode);
+  sample.fan = static_cast<uint8_t>(this->fan_mode.value_or(climate::CLIMATE_FAN_AUTO));
+  sample.swing = static_cast<uint8_t>(this->swing_mode);
+  if (!std::isnan(this->target_temperature)) {
+    sample.setpoint = static_cast<int16_t>(lroundf(this->target_temperature * 10.0f));
+  }
+  if (!std::isnan(this->current_temperature)) {
+    sample.indoor = static_cast<int16_t>(lroundf(this->current_temperature * 10.0f));
+  }
+  sample.link_errors = this->checksum_errors_ + this->invalid_packet_errors_ + this->timeout_errors_ +
+                       this->tx_collisions_.load(std::memory_order_relaxed);
+  this->history_.record(sample);
+}
+
+size_t GreeAC::get_history_csv(char *out, size_t out_size, uint32_t hours) {
+  if (!this->history_.is_enabled()) {
+    if (out_size > 0) {
+      out[0] = '\0';
+    }
+    return 0;
+  }
+  uint32_t now_s = static_cast<uint32_t>((this->history_uptime_ms_ + (millis() - this->last_history_sample_)) / 1000);
+  uint32_t window_s = hours * 3600;
+  uint32_t since_s = now_s > window_s ? now_s - window_s : 0;
+  return this->history_.to_csv(out, out_size, since_s);
+}
+
+void GreeAC::on_horizontal_swing_change_(size_t index) {
+  ESP_LOGD(TAG, "Horizontal swing changed to option %u", static_cast<unsigned>(index));
+  this->horizontal_swing_index_ = static_cast<uint8_t>(index);
   // Placeholder: map value to protocol byte and send command
 }
 
-void GreeAC::on_vertical_swing_change_(const std::string &value) {
-  ESP_LOGD(TAG, "Vertical swing changed to: %s", value.c_str());
+void GreeAC::on_vertical_swing_change_(size_t index) {
+  ESP_LOGD(TAG, "Vertical swing changed to option %u", static_cast<unsigned>(index));
+  this->vertical_swing_index_ = static_cast<uint8_t>(index);
   // Placeholder: map value to protocol byte and send command
 }
 
-void GreeAC::on_display_change_(const std::string &value) {
-  ESP_LOGD(TAG, "Display changed to: %s", value.c_str());
+void GreeAC::on_display_change_(size_t index) {
+  ESP_LOGD(TAG, "Display changed to option %u", static_cast<unsigned>(index));
+  this->display_index_ = static_cast<uint8_t>(index);
   // Placeholder: map value to protocol byte and send command
 }
 
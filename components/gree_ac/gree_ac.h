@@ -1,14 +1,24 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/components/climate/climate.h"
 #include "esphome/components/uart/uart.h"
 #include "esphome/components/sensor/sensor.h"
+#include "frame_queue.h"
+#include "state_history.h"
+#include <atomic>
 #include <set>
 
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 namespace esphome {
 namespace select { class Select; }
 namespace switch_ { class Switch; }
+namespace number { class Number; }
 namespace gree_ac {
 
 static const char *const TAG = "gree_ac";
@@ -28,6 +38,7 @@ static const uint8_t GREE_TX_BUFFER_SIZE = 47;
 
 // Packet types
 static const uint8_t CMD_IN_UNIT_REPORT = 0x31;
+static const uint8_t CMD_IN_OUTDOOR_REPORT = 0x33;  // Extended telemetry, some units only (experimental)
 static const uint8_t CMD_OUT_PARAMS_SET = 0x01;
 
 // Presets (packet values)
@@ -42,20 +53,36 @@ static const uint8_t AC_SWING_VERTICAL = 0x14;
 static const uint8_t AC_SWING_HORIZONTAL = 0x41;
 static const uint8_t AC_SWING_BOTH = 0x11;
 
+// Built-in on/off timers: bit 7 arms the timer, bits 0-5 hold half-hour steps.
+// 0x00 (what every non-timer frame carries) leaves a timer as it is; the
+// enable bit with zero steps cancels it.
+static const uint8_t TIMER_ENABLE_MASK = 0x80;
+static const uint8_t TIMER_VALUE_MASK = 0x3F;
+static const uint8_t TIMER_UNCHANGED = 0x00;
+static const uint8_t TIMER_CANCEL = TIMER_ENABLE_MASK;
+static const uint16_t TIMER_STEP_MINUTES = 30;
+static const uint16_t TIMER_MAX_MINUTES = 24 * 60;
+
 // Timing constants
 static const uint32_t HANDSHAKE_RETRY_INTERVAL_MS = 5000;  // Retry handshake every 5 seconds
 static const uint32_t PACKET_TIMEOUT_MS = 1000;            // Consider AC inactive after 1 second
 static const uint32_t MIN_PACKET_INTERVAL_MS = 300;        // Minimum time between packets
+static const uint32_t TX_GUARD_TIME_MS = 20;               // Default idle time on RX before we may transmit
+static const uint32_t TX_MAX_DEFER_MS = 1000;              // Send anyway if the line never goes idle
+static const uint8_t UART_BITS_PER_BYTE = 11;              // Start + 8 data + even parity + stop
+
+// RX task (ESP32 only)
+static const uint32_t RX_TASK_STACK_SIZE = 3072;
+static const uint8_t RX_TASK_PRIORITY = 5;
+static const uint32_t RX_TASK_POLL_MS = 5;
+static const size_t RX_QUEUE_DEPTH = 8;                    // Frames buffered between RX task and loop()
 
-// Fan modes
-namespace fan_modes {
-const char *const FAN_AUTO = "Auto";
-const char *const FAN_QUIET = "Quiet";
-const char *const FAN_LOW = "Low";
-const char *const FAN_MEDIUM = "Medium";
-const char *const FAN_HIGH = "High";
-const char *const FAN_TURBO = "Turbo";
-}  // namespace fan_modes
+// Protocol error reporting
+static const uint32_t ERROR_LOG_INTERVAL_MS = 60000;       // Default summary interval
+static const uint8_t ERROR_LOG_BURST = 3;                  // Immediate error lines allowed before summarising
+
+// State history
+static const uint32_t HISTORY_INTERVAL_MS = 60000;         // Default sampling interval
 
 // AC Modes
 enum class ACMode : uint8_t {
@@ -94,6 +121,18 @@ enum class SerialState {
   COMPLETE
 };
 
+// Protocol error categories, aggregated and reported once per interval
+enum class ProtocolError : uint8_t {
+  NONE = 0,
+  PACKET,       // Malformed or truncated frame
+  CHECKSUM,
+  TEMPERATURE,  // Temperature out of range
+  MODE,         // Unknown mode
+  FAN,          // Unknown fan speed
+  SWING,        // Unknown swing value
+  COUNT
+};
+
 // Packet structures
 union gree_start_bytes_t {
   uint8_t u8x2[2];
@@ -133,6 +172,22 @@ class GreeAC : public PollingComponent, public uart::UARTDevice, public climate:
   void set_sleep_switch(switch_::Switch *sw) { this->sleep_switch_ = sw; }
   void set_xfan_switch(switch_::Switch *sw) { this->xfan_switch_ = sw; }
   void set_current_temperature_sensor(sensor::Sensor *sensor) { this->current_temperature_sensor_ = sensor; }
+  void set_outdoor_temperature_sensor(sensor::Sensor *sensor) { this->outdoor_temperature_sensor_ = sensor; }
+  void set_compressor_frequency_sensor(sensor::Sensor *sensor) { this->compressor_frequency_sensor_ = sensor; }
+  void set_on_timer_number(number::Number *number) { this->on_timer_number_ = number; }
+  void set_off_timer_number(number::Number *number) { this->off_timer_number_ = number; }
+  void set_tx_guard_time(uint32_t guard_time_ms) { this->tx_guard_time_ = guard_time_ms; }
+  void set_error_log_interval(uint32_t interval_ms) { this->error_log_interval_ = interval_ms; }
+  void set_error_log_burst(uint8_t burst) {
+    this->error_log_burst_ = burst;
+    this->error_log_tokens_ = burst;
+  }
+  void set_history_size(size_t size) { this->history_size_ = size; }
+  void set_history_interval(uint32_t interval_ms) { this->history_interval_ = interval_ms; }
+#ifdef USE_ESP32
+  void set_rx_task(bool enabled) { this->rx_task_enabled_ = enabled; }
+  void set_rx_task_core(uint8_t core) { this->rx_task_core_ = core; }
+#endif
   void set_supported_presets(const std::set<climate::ClimatePreset> &presets) {
     this->supported_presets_ = presets;
   }
@@ -140,47 +195,100 @@ class GreeAC : public PollingComponent, public uart::UARTDevice, public climate:
     this->supported_swing_modes_ = modes;
   }
 
+  // Built-in timers, run by the indoor unit itself. Minutes are rounded to
+  // 30-minute steps (max 24h); 0 cancels the timer. Experimental: the byte
+  // layout is unconfirmed.
+  void set_on_timer(uint16_t minutes);
+  void set_off_timer(uint16_t minutes);
+  uint16_t get_on_timer() const { return this->on_timer_minutes_; }
+  uint16_t get_off_timer() const { return this->off_timer_minutes_; }
+
+  // Local state history. Writes the last `hours` as CSV into out and returns
+  // the number of characters written (0 if history is disabled).
+  size_t get_history_csv(char *out, size_t out_size, uint32_t hours);
+  const StateHistory &get_history() const { return this->history_; }
+
+  // TX scheduling diagnostics
+  uint32_t get_tx_collisions() const { return this->tx_collisions_.load(std::memory_order_relaxed); }
+  uint32_t get_tx_ignored_commands() const { return this->tx_ignored_commands_; }
+  uint32_t get_unknown_frames() const { return this->unknown_frames_; }
+  // Frames the RX task had to drop because loop() fell behind (0 without the task)
+  uint32_t get_rx_dropped_frames() const {
+#ifdef USE_ESP32
+    return this->rx_queue_.get_dropped();
+#else
+    return 0;
+#endif
+  }
+
  protected:
   // Communication
   void read_uart_data_();
+  bool frame_byte_(uint8_t byte, uint8_t &frame_size);
+#ifdef USE_ESP32
+  static void rx_task_(void *arg);
+  void drain_rx_queue_();
+#endif
   void send_packet_();
-  bool verify_packet_(const uint8_t *data, uint8_t size);
+  void request_send_();
+  bool tx_window_open_(uint32_t now);
+  uint32_t rx_idle_ms_(uint32_t now) const;
+  ProtocolError verify_packet_(const uint8_t *data, uint8_t size);
+  void report_error_(ProtocolError error, const uint8_t *data, uint8_t size);
+  void flush_error_summary_(uint32_t now);
   void handle_packet_(const uint8_t *data, uint8_t size);
+
+  // Frame dispatch, indexed through FRAME_TYPE_INDEX by the command byte (data[3])
+  using FrameHandler = void (GreeAC::*)(const uint8_t *data, uint8_t size);
+  static const FrameHandler FRAME_HANDLERS[];
+  void handle_unknown_frame_(const uint8_t *data, uint8_t size);
+  void handle_unit_report_(const uint8_t *data, uint8_t size);
+  void handle_outdoor_report_(const uint8_t *data, uint8_t size);
   uint8_t calculate_checksum_(const uint8_t *data, size_t size);
   void log_packet_(const uint8_t *data, uint8_t size, bool outgoing = false);
 
   // State parsing
-  void parse_state_packet_(const uint8_t *data, uint8_t size);
+  bool parse_state_packet_(const uint8_t *data, uint8_t size, uint64_t changed);
+  void invalidate_reports_();
   climate::ClimateMode parse_mode_(uint8_t mode_byte);
   const char *parse_fan_mode_(uint8_t mode_byte);
   climate::ClimatePreset parse_preset_(uint8_t preset_byte, ACMode mode);
 
   // Packet building
   void build_state_packet_();
+  void send_timer_(uint8_t timer_byte, uint16_t minutes);
+  static uint8_t encode_timer_(uint16_t minutes);
+  static uint16_t decode_timer_(uint8_t timer_byte);
 
   // Optional component callbacks
   void setup_select_callbacks_();
   void setup_switch_callbacks_();
-  void on_horizontal_swing_change_(const std::string &value);
-  void on_vertical_swing_change_(const std::string &value);
-  void on_display_change_(const std::string &value);
+  // Selects report the option index so the hot path never touches std::string
+  void on_horizontal_swing_change_(size_t index);
+  void on_vertical_swing_change_(size_t index);
+  void on_display_change_(size_t index);
   void on_plasma_change_(bool state);
   void on_sleep_change_(bool state);
   void on_xfan_change_(bool state);
 
   // Update helpers
   void update_swing_states_();
+  void record_history_(uint32_t now);
   climate::ClimateAction determine_action_();
+  void build_traits_();
 
   // State variables
   ACState state_ = ACState::INITIALIZING;
   UpdateState update_state_ = UpdateState::NO_UPDATE;
-  SerialState serial_state_ = SerialState::WAIT_SYNC;
+  std::atomic<SerialState> serial_state_{SerialState::WAIT_SYNC};
 
   // Timing
   uint32_t last_packet_sent_ = 0;
-  uint32_t last_packet_received_ = 0;
+  std::atomic<uint32_t> last_packet_received_{0};  // Last RX byte, written by the RX task when enabled
   uint32_t last_handshake_attempt_ = 0;
+  uint32_t tx_pending_since_ = 0;
+  std::atomic<uint32_t> tx_busy_until_{0};
+  uint32_t tx_guard_time_ = TX_GUARD_TIME_MS;
 
   // Buffers
   uint8_t tx_buffer_[GREE_TX_BUFFER_SIZE] = {
@@ -189,25 +297,68 @@ class GreeAC : public PollingComponent, public uart::UARTDevice, public climate:
       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
   uint8_t rx_buffer_[GREE_RX_BUFFER_SIZE] = {0};
+
+  // Previous frame of each decoded type; a size of 0 forces a full decode
+  uint8_t last_report_[GREE_RX_BUFFER_SIZE] = {0};
+  uint8_t last_report_size_ = 0;
+  uint8_t last_outdoor_report_[GREE_RX_BUFFER_SIZE] = {0};
+  uint8_t last_outdoor_report_size_ = 0;
   uint8_t rx_index_ = 0;
   bool receiving_packet_ = false;
 
-  // Diagnostics / statistics
+#ifdef USE_ESP32
+  // Framing and checksum verification off the main loop
+  bool rx_task_enabled_ = false;
+  uint8_t rx_task_core_ = 1;
+  TaskHandle_t rx_task_handle_ = nullptr;
+  FrameQueue<GREE_RX_BUFFER_SIZE, RX_QUEUE_DEPTH> rx_queue_;
+  uint32_t rx_dropped_reported_ = 0;  // Drop count already logged by flush_error_summary_()
+#endif
+
+  // Diagnostics / statistics. All written from loop() except tx_collisions_,
+  // which the RX task updates when enabled.
   uint32_t packets_received_ = 0;
   uint32_t packets_sent_ = 0;
   uint32_t checksum_errors_ = 0;
   uint32_t timeout_errors_ = 0;
   uint32_t invalid_packet_errors_ = 0;
+  uint32_t protocol_errors_ = 0;     // All categories, since boot
+  uint32_t unknown_frames_ = 0;      // Valid frames of a type we don't decode
+  std::atomic<uint32_t> tx_collisions_{0};  // Unit started a report while we were transmitting
+  uint32_t tx_ignored_commands_ = 0;  // Command frame not followed by any report
+  bool command_in_flight_ = false;
 
   // Internal state tracking
   ACMode mode_internal_ = ACMode::OFF;
   bool power_internal_ = false;
-  std::string horizontal_swing_state_ = "Center";
-  std::string vertical_swing_state_ = "Center";
-  std::string display_state_ = "On";
+  bool publish_pending_ = false;  // Coalesces state publishes into one per loop()
+  uint8_t horizontal_swing_index_ = 0;
+  uint8_t vertical_swing_index_ = 0;
+  uint8_t display_index_ = 0;
   bool plasma_state_ = false;
   bool sleep_state_ = false;
   bool xfan_state_ = false;
+  uint16_t on_timer_minutes_ = 0;
+  uint16_t off_timer_minutes_ = 0;
+
+  // Aggregated error reporting: per-category counts and the first offending
+  // frame of the current interval, plus a token bucket for immediate lines
+  uint32_t error_log_interval_ = ERROR_LOG_INTERVAL_MS;
+  uint32_t last_error_summary_ = 0;
+  uint8_t error_log_burst_ = ERROR_LOG_BURST;
+  uint8_t error_log_tokens_ = ERROR_LOG_BURST;
+  uint16_t error_counts_[static_cast<uint8_t>(ProtocolError::COUNT)] = {0};
+  uint16_t errors_suppressed_ = 0;
+  ProtocolError first_error_ = ProtocolError::NONE;
+  uint8_t first_error_frame_[GREE_RX_BUFFER_SIZE] = {0};
+  uint8_t first_error_size_ = 0;
+
+  // State history
+  StateHistory history_;
+  size_t history_size_ = 0;
+  uint32_t history_interval_ = HISTORY_INTERVAL_MS;
+  uint32_t last_history_sample_ = 0;
+  uint64_t history_uptime_ms_ = 0;
 
   // Optional components
   select::Select *horizontal_swing_select_ = nullptr;
@@ -217,10 +368,16 @@ class GreeAC : public PollingComponent, public uart::UARTDevice, public climate:
   switch_::Switch *sleep_switch_ = nullptr;
   switch_::Switch *xfan_switch_ = nullptr;
   sensor::Sensor *current_temperature_sensor_ = nullptr;
+  sensor::Sensor *outdoor_temperature_sensor_ = nullptr;
+  sensor::Sensor *compressor_frequency_sensor_ = nullptr;
+  number::Number *on_timer_number_ = nullptr;
+  number::Number *off_timer_number_ = nullptr;
 
   // Supported features
   std::set<climate::ClimatePreset> supported_presets_{};
   std::set<climate::ClimateSwingMode> supported_swing_modes_{};
+  climate::ClimateTraits traits_{};  // Built once in setup(), copied out by traits()
+  bool traits_built_ = false;
 };
 
 }  // namespace gree_ac
@@ -0,0 +1,184 @@
+#include "state_history.h"
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+namespace esphome {
+namespace gree_ac {
+
+// Change mask bits (first byte of every record)
+static const uint8_t FIELD_MODE = 0x01;
+static const uint8_t FIELD_FAN = 0x02;
+static const uint8_t FIELD_SWING = 0x04;
+static const uint8_t FIELD_SETPOINT = 0x08;
+static const uint8_t FIELD_INDOOR = 0x10;
+static const uint8_t FIELD_LINK_ERRORS = 0x20;
+
+static size_t put_varint(uint8_t *out, uint32_t value) {
+  size_t len = 0;
+  while (value >= 0x80) {
+    out[len++] = static_cast<uint8_t>(value) | 0x80;
+    value >>= 7;
+  }
+  out[len++] = static_cast<uint8_t>(value);
+  return len;
+}
+
+static uint32_t zigzag(int32_t value) {
+  return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+  return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+bool StateHistory::init(size_t size) {
+  this->buffer_.reset(new (std::nothrow) uint8_t[size]);
+  if (!this->buffer_) {
+    this->size_ = 0;
+    return false;
+  }
+  this->size_ = size;
+  return true;
+}
+
+bool StateHistory::record(const HistorySample &sample) {
+  if (!this->is_enabled()) {
+    return false;
+  }
+  const HistorySample &prev = this->newest_;
+  uint8_t mask = 0;
+  if (sample.mode != prev.mode)
+    mask |= FIELD_MODE;
+  if (sample.fan != prev.fan)
+    mask |= FIELD_FAN;
+  if (sample.swing != prev.swing)
+    mask |= FIELD_SWING;
+  if (sample.setpoint != prev.setpoint)
+    mask |= FIELD_SETPOINT;
+  if (sample.indoor != prev.indoor)
+    mask |= FIELD_INDOOR;
+  if (sample.link_errors != prev.link_errors)
+    mask |= FIELD_LINK_ERRORS;
+  if (mask == 0) {
+    return false;
+  }
+
+  uint8_t rec[MAX_RECORD_SIZE];
+  size_t len = 0;
+  rec[len++] = mask;
+  len += put_varint(rec + len, sample.time_s - prev.time_s);
+  if (mask & FIELD_MODE)
+    rec[len++] = sample.mode;
+  if (mask & FIELD_FAN)
+    rec[len++] = sample.fan;
+  if (mask & FIELD_SWING)
+    rec[len++] = sample.swing;
+  if (mask & FIELD_SETPOINT)
+    len += put_varint(rec + len, zigzag(static_cast<int32_t>(sample.setpoint) - prev.setpoint));
+  if (mask & FIELD_INDOOR)
+    len += put_varint(rec + len, zigzag(static_cast<int32_t>(sample.indoor) - prev.indoor));
+  if (mask & FIELD_LINK_ERRORS)
+    len += put_varint(rec + len, sample.link_errors - prev.link_errors);
+
+  if (len > this->size_) {
+    return false;
+  }
+  while (this->size_ - this->used_ < len) {
+    this->evict_oldest_();
+  }
+  for (size_t i = 0; i < len; i++) {
+    this->buffer_[this->head_] = rec[i];
+    this->head_ = (this->head_ + 1) % this->size_;
+  }
+  this->used_ += len;
+  this->records_++;
+  this->newest_ = sample;
+  return true;
+}
+
+void StateHistory::evict_oldest_() {
+  // Positions are linear inside decode_(); only indexing wraps
+  size_t next = this->decode_(this->tail_, this->base_);
+  this->used_ -= next - this->tail_;
+  this->tail_ = next % this->size_;
+  this->records_--;
+  this->has_base_ = true;
+}
+
+uint8_t StateHistory::read_(size_t &pos) const { return this->buffer_[pos++ % this->size_]; }
+
+uint32_t StateHistory::read_varint_(size_t &pos) const {
+  uint32_t value = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    uint8_t byte = this->read_(pos);
+    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      break;
+    }
+  }
+  return value;
+}
+
+size_t StateHistory::decode_(size_t pos, HistorySample &state) const {
+  uint8_t mask = this->read_(pos);
+  state.time_s += this->read_varint_(pos);
+  if (mask & FIELD_MODE)
+    state.mode = this->read_(pos);
+  if (mask & FIELD_FAN)
+    state.fan = this->read_(pos);
+  if (mask & FIELD_SWING)
+    state.swing = this->read_(pos);
+  if (mask & FIELD_SETPOINT)
+    state.setpoint = static_cast<int16_t>(state.setpoint + unzigzag(this->read_varint_(pos)));
+  if (mask & FIELD_INDOOR)
+    state.indoor = static_cast<int16_t>(state.indoor + unzigzag(this->read_varint_(pos)));
+  if (mask & FIELD_LINK_ERRORS)
+    state.link_errors += this->read_varint_(pos);
+  return pos;
+}
+
+static int format_temperature(char *out, size_t out_size, int16_t tenths) {
+  if (tenths == HistorySample::NO_TEMPERATURE) {
+    out[0] = '\0';
+    return 0;
+  }
+  return snprintf(out, out_size, "%.1f", tenths / 10.0f);
+}
+
+size_t StateHistory::to_csv(char *out, size_t out_size, uint32_t since_s) const {
+  if (out_size == 0) {
+    return 0;
+  }
+  static const char *const HEADER = "time_s,mode,fan,swing,setpoint,indoor,link_errors\n";
+  size_t len = strlen(HEADER);
+  if (len >= out_size) {
+    out[0] = '\0';
+    return 0;
+  }
+  memcpy(out, HEADER, len + 1);
+
+  bool full = false;
+  this->for_each(since_s, [&](const HistorySample &sample) {
+    if (full) {
+      return;
+    }
+    char setpoint[8];
+    char indoor[8];
+    format_temperature(setpoint, sizeof(setpoint), sample.setpoint);
+    format_temperature(indoor, sizeof(indoor), sample.indoor);
+    int row = snprintf(out + len, out_size - len, "%u,%u,%u,%u,%s,%s,%u\n", static_cast<unsigned>(sample.time_s),
+                       sample.mode, sample.fan, sample.swing, setpoint, indoor,
+                       static_cast<unsigned>(sample.link_errors));
+    if (row < 0 || static_cast<size_t>(row) >= out_size - len) {
+      out[len] = '\0';  // Drop the partial row
+      full = true;
+      return;
+    }
+    len += row;
+  });
+  return len;
+}
+
+}  // namespace gree_ac
+}  // namespace esphome
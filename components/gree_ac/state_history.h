@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace esphome {
+namespace gree_ac {
+
+// One decoded state snapshot. Temperatures are in tenths of a degree.
+struct HistorySample {
+  static const int16_t NO_TEMPERATURE = INT16_MIN;
+
+  uint32_t time_s = 0;  // Uptime in seconds
+  uint8_t mode = 0;     // climate::ClimateMode
+  uint8_t fan = 0;      // climate::ClimateFanMode
+  uint8_t swing = 0;    // climate::ClimateSwingMode
+  int16_t setpoint = NO_TEMPERATURE;
+  int16_t indoor = NO_TEMPERATURE;
+  uint32_t link_errors = 0;  // Cumulative
+};
+
+// Fixed-size in-RAM history of decoded state.
+//
+// Each record is a change mask, a varint time delta and only the fields that
+// changed (temperatures and error count as varint deltas), so a steady unit
+// costs a few bytes per sample. When the ring is full the oldest record is
+// folded into base_ so the remaining deltas still decode.
+class StateHistory {
+ public:
+  // Allocates the ring once. Returns false if the buffer can't be allocated.
+  bool init(size_t size);
+  bool is_enabled() const { return this->size_ != 0; }
+  size_t get_size() const { return this->size_; }
+  size_t get_used() const { return this->used_; }
+  uint32_t get_records() const { return this->records_; }
+
+  // Appends a record if anything differs from the newest sample. Returns true if written.
+  bool record(const HistorySample &sample);
+
+  // Calls fn(const HistorySample &) for every sample at or after since_s, oldest
+  // first. The sample in effect at since_s is reported first with its own time.
+  template<typename F> void for_each(uint32_t since_s, F &&fn) const {
+    // Once records were evicted, base_ is a real state that comes before them
+    HistorySample state = this->base_;
+    bool before_window = false;
+    if (this->has_base_) {
+      if (state.time_s < since_s) {
+        before_window = true;
+      } else {
+        fn(state);
+      }
+    }
+    size_t pos = this->tail_;
+    for (uint32_t i = 0; i < this->records_; i++) {
+      HistorySample previous = state;
+      pos = this->decode_(pos, state);
+      if (state.time_s < since_s) {
+        before_window = true;
+        continue;
+      }
+      if (before_window) {
+        fn(previous);
+        before_window = false;
+      }
+      fn(state);
+    }
+    if (before_window) {
+      fn(state);
+    }
+  }
+
+  // Writes samples at or after since_s as CSV into out (always NUL-terminated).
+  // Returns the number of characters written; rows that don't fit are dropped.
+  size_t to_csv(char *out, size_t out_size, uint32_t since_s) const;
+
+ protected:
+  static const size_t MAX_RECORD_SIZE = 24;
+
+  size_t decode_(size_t pos, HistorySample &state) const;
+  uint8_t read_(size_t &pos) const;
+  uint32_t read_varint_(size_t &pos) const;
+  void evict_oldest_();
+
+  std::unique_ptr<uint8_t[]> buffer_;
+  size_t size_ = 0;
+  size_t head_ = 0;  // Next write position
+  size_t tail_ = 0;  // Oldest record
+  size_t used_ = 0;
+  uint32_t records_ = 0;
+  HistorySample base_{};    // State before the oldest record
+  bool has_base_ = false;   // base_ holds folded records, not the initial defaults
+  HistorySample newest_{};  // State after the newest record
+};
+
+}  // namespace gree_ac
+}  // namespace esphome
@@ -0,0 +1,159 @@
+// Replays a stream of unit frames through GreeAC on the host and fails if
+// anything allocates on the heap once setup() has returned. The stream mixes
+// state changes, extended and unknown frame types, bad checksums and line
+// noise; control(), timer commands, polls and history export run alongside.
+
+#include "gree_ac.h"
+#include "esphome/components/number/number.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+static bool g_counting = false;
+static size_t g_allocations = 0;
+
+void *operator new(size_t size) {
+  if (g_counting) {
+    g_allocations++;
+  }
+  void *ptr = malloc(size != 0 ? size : 1);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return operator new(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete[](void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { free(ptr); }
+
+namespace esphome {
+static uint32_t g_now_ms = 0;
+uint32_t millis() { return g_now_ms; }
+}  // namespace esphome
+
+using namespace esphome;
+
+static const uint32_t REPORTS = 20000;
+static const uint32_t REPORT_PERIOD_MS = 200;
+static const size_t CHUNK_BYTES = 16;  // Bytes the UART hands over per loop()
+
+class TestGreeAC : public gree_ac::GreeAC {
+ public:
+  using GreeAC::calculate_checksum_;
+  uint32_t get_packets_received() const { return this->packets_received_; }
+  uint32_t get_protocol_errors() const { return this->protocol_errors_; }
+};
+
+static void append_frame(TestGreeAC &ac, std::vector<uint8_t> &stream, uint8_t *frame, uint8_t size) {
+  frame[size - 1] = ac.calculate_checksum_(frame, size);
+  stream.insert(stream.end(), frame, frame + size);
+}
+
+static std::vector<uint8_t> build_stream(TestGreeAC &ac) {
+  std::vector<uint8_t> stream;
+  uint8_t report[52] = {0x7E, 0x7E, 49, gree_ac::CMD_IN_UNIT_REPORT};
+  uint8_t outdoor[20] = {0x7E, 0x7E, 17, gree_ac::CMD_IN_OUTDOOR_REPORT};
+  uint8_t unknown[12] = {0x7E, 0x7E, 9, 0x44};
+  for (uint32_t i = 0; i < REPORTS; i++) {
+    report[8] = (i / 50) % 2 == 0 ? 0x91 : 0xC2;        // Mode/fan, changes every 50 reports
+    report[9] = static_cast<uint8_t>((i / 30) % 14 * 16);  // Setpoint
+    report[10] = gree_ac::PRESET_COOL_NORMAL;
+    report[12] = gree_ac::AC_SWING_OFF;
+    report[15] = i % 400 < 200 ? 0x83 : 0x00;  // Off timer
+    report[46] = static_cast<uint8_t>(62 + (i / 40) % 6);  // Indoor temperature
+    append_frame(ac, stream, report, sizeof(report));
+
+    if (i % 10 == 0) {
+      outdoor[4] = static_cast<uint8_t>(70 + (i / 100) % 5);
+      outdoor[5] = static_cast<uint8_t>((i / 20) % 80);
+      append_frame(ac, stream, outdoor, sizeof(outdoor));
+    }
+    if (i % 37 == 0) {
+      append_frame(ac, stream, unknown, sizeof(unknown));
+    }
+    if (i % 53 == 0) {
+      append_frame(ac, stream, report, sizeof(report));
+      stream[stream.size() - 1] ^= 0x5A;  // Checksum error
+    }
+    if (i % 97 == 0) {
+      stream.push_back(0x13);  // Line noise between frames
+      stream.push_back(0x37);
+    }
+  }
+  return stream;
+}
+
+int main() {
+  TestGreeAC ac;
+  number::Number off_timer;
+  ac.set_off_timer_number(&off_timer);
+  ac.set_history_size(2048);
+  ac.set_history_interval(1000);
+  ac.set_error_log_interval(5000);
+  ac.setup();
+  uint32_t traits_builds = climate::ClimateTraits::builds;
+
+  std::vector<uint8_t> stream = build_stream(ac);
+  climate::ClimateCall call;
+  call.set_mode(climate::CLIMATE_MODE_COOL).set_target_temperature(24.0f);
+  static char csv[512];
+
+  // Bytes per chunk arrive at roughly the line rate of a report period
+  size_t chunks_per_report = 52 / CHUNK_BYTES + 1;
+  uint32_t chunk_ms = REPORT_PERIOD_MS / chunks_per_report;
+
+  g_counting = true;
+  uint32_t next_poll = 0;
+  for (size_t pos = 0; pos < stream.size(); pos += CHUNK_BYTES) {
+    size_t size = stream.size() - pos < CHUNK_BYTES ? stream.size() - pos : CHUNK_BYTES;
+    ac.feed(stream.data() + pos, size);
+    esphome::g_now_ms += chunk_ms;
+    ac.loop();
+    if (esphome::g_now_ms >= next_poll) {
+      next_poll = esphome::g_now_ms + 1000;
+      ac.update();
+      uint32_t second = esphome::g_now_ms / 1000;
+      if (second % 7 == 0) {
+        ac.control(call);
+      }
+      if (second % 13 == 0) {
+        ac.set_on_timer(90);
+      }
+      if (second % 60 == 0) {
+        ac.get_history_csv(csv, sizeof(csv), 1);
+      }
+    }
+  }
+  g_counting = false;
+
+  printf("hot_path_alloc_test: reports=%u protocol_errors=%u publishes=%u tx_bytes=%zu history=%u allocations=%zu\n",
+         ac.get_packets_received(), ac.get_protocol_errors(), ac.publish_count, ac.get_tx_bytes(),
+         ac.get_history().get_records(), g_allocations);
+
+  bool ok = true;
+  if (g_allocations != 0) {
+    printf("FAILED: %zu heap allocations after setup()\n", g_allocations);
+    ok = false;
+  }
+  if (climate::ClimateTraits::builds != traits_builds) {
+    printf("FAILED: traits rebuilt %u times after setup()\n", climate::ClimateTraits::builds - traits_builds);
+    ok = false;
+  }
+  if (ac.get_packets_received() == 0 || ac.publish_count == 0 || ac.get_tx_bytes() == 0) {
+    printf("FAILED: stream was not decoded\n");
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
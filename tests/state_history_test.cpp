@@ -0,0 +1,121 @@
+// Checks StateHistory against a plain list of every sample written. After
+// eviction the ring must still decode to exactly the newest samples, and a
+// windowed for_each() must start with the sample in effect at the window
+// start, even when that sample only survives folded into the base state.
+
+#include "state_history.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using esphome::gree_ac::HistorySample;
+using esphome::gree_ac::StateHistory;
+
+static bool same(const HistorySample &a, const HistorySample &b) {
+  return a.time_s == b.time_s && a.mode == b.mode && a.fan == b.fan && a.swing == b.swing &&
+         a.setpoint == b.setpoint && a.indoor == b.indoor && a.link_errors == b.link_errors;
+}
+
+// Samples the ring still knows about: the folded base (if anything was
+// evicted) followed by the surviving records
+static std::vector<HistorySample> retained(const std::vector<HistorySample> &written, uint32_t records) {
+  size_t first = written.size() - records;
+  if (first > 0) {
+    first--;
+  }
+  return std::vector<HistorySample>(written.begin() + first, written.end());
+}
+
+static std::vector<HistorySample> expected_window(const std::vector<HistorySample> &known, uint32_t since_s) {
+  std::vector<HistorySample> out;
+  for (size_t i = 0; i < known.size(); i++) {
+    if (known[i].time_s >= since_s) {
+      if (out.empty() && i > 0) {
+        out.push_back(known[i - 1]);  // In effect at since_s
+      }
+      out.push_back(known[i]);
+    }
+  }
+  if (out.empty() && !known.empty()) {
+    out.push_back(known.back());
+  }
+  return out;
+}
+
+static bool check_window(const StateHistory &history, const std::vector<HistorySample> &written, uint32_t since_s) {
+  std::vector<HistorySample> got;
+  history.for_each(since_s, [&](const HistorySample &sample) { got.push_back(sample); });
+  std::vector<HistorySample> want = expected_window(retained(written, history.get_records()), since_s);
+  if (got.size() != want.size()) {
+    printf("  since=%u: got %zu samples, want %zu\n", since_s, got.size(), want.size());
+    return false;
+  }
+  for (size_t i = 0; i < got.size(); i++) {
+    if (!same(got[i], want[i])) {
+      printf("  since=%u: sample %zu differs (time %u, want %u)\n", since_s, i, got[i].time_s, want[i].time_s);
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool run(size_t capacity, uint32_t seed) {
+  StateHistory history;
+  if (!history.init(capacity)) {
+    return false;
+  }
+  std::mt19937 rng(seed);
+  std::vector<HistorySample> written;
+  HistorySample sample;
+  for (int i = 0; i < 20000; i++) {
+    sample.time_s += 1 + rng() % 300;
+    if (rng() % 5 == 0)
+      sample.mode = rng() % 7;
+    if (rng() % 7 == 0)
+      sample.fan = rng() % 6;
+    if (rng() % 9 == 0)
+      sample.swing = rng() % 4;
+    if (rng() % 4 == 0)
+      sample.setpoint = static_cast<int16_t>(160 + 10 * (rng() % 15));
+    if (rng() % 2 == 0)
+      sample.indoor = rng() % 3 == 0 ? HistorySample::NO_TEMPERATURE : static_cast<int16_t>(rng() % 900) - 200;
+    if (rng() % 20 == 0)
+      sample.link_errors += rng() % 100000;
+    if (history.record(sample)) {
+      written.push_back(sample);
+    }
+
+    if (i % 997 != 0 || written.empty()) {
+      continue;
+    }
+    std::vector<HistorySample> known = retained(written, history.get_records());
+    const HistorySample &oldest = known.front();
+    uint32_t windows[] = {0, oldest.time_s, oldest.time_s + 1, known[known.size() / 2].time_s,
+                          known.back().time_s, known.back().time_s + 1000};
+    for (uint32_t since_s : windows) {
+      if (!check_window(history, written, since_s)) {
+        printf("FAILED: capacity=%zu after %zu samples\n", capacity, written.size());
+        return false;
+      }
+    }
+  }
+
+  char csv[128];
+  size_t len = history.to_csv(csv, sizeof(csv), 0);
+  if (len != strlen(csv) || len >= sizeof(csv)) {
+    printf("FAILED: capacity=%zu CSV length %zu\n", capacity, len);
+    return false;
+  }
+  printf("state_history_test: capacity=%zu records=%u used=%zu\n", capacity, history.get_records(), history.get_used());
+  return true;
+}
+
+int main() {
+  bool ok = true;
+  for (size_t capacity : {24, 40, 97, 512, 4096}) {
+    ok = run(capacity, static_cast<uint32_t>(capacity)) && ok;
+  }
+  return ok ? 0 : 1;
+}
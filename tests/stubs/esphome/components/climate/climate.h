@@ -0,0 +1,131 @@
+#pragma once
+// Host stub of the ESPHome climate API. ClimateTraits mirrors the current
+// bitmask-based traits (no heap use) and counts how often supported modes are
+// set, so tests can check the traits aren't rebuilt. publish_state() calls
+// get_traits() like the real Climate does.
+
+#include "esphome/core/component.h"
+#include <initializer_list>
+#include <optional>
+
+namespace esphome {
+namespace climate {
+
+enum ClimateMode : uint8_t {
+  CLIMATE_MODE_OFF,
+  CLIMATE_MODE_HEAT_COOL,
+  CLIMATE_MODE_COOL,
+  CLIMATE_MODE_HEAT,
+  CLIMATE_MODE_FAN_ONLY,
+  CLIMATE_MODE_DRY,
+  CLIMATE_MODE_AUTO,
+};
+enum ClimateFanMode : uint8_t {
+  CLIMATE_FAN_ON,
+  CLIMATE_FAN_OFF,
+  CLIMATE_FAN_AUTO,
+  CLIMATE_FAN_LOW,
+  CLIMATE_FAN_MEDIUM,
+  CLIMATE_FAN_HIGH,
+};
+enum ClimateSwingMode : uint8_t {
+  CLIMATE_SWING_OFF,
+  CLIMATE_SWING_BOTH,
+  CLIMATE_SWING_VERTICAL,
+  CLIMATE_SWING_HORIZONTAL,
+};
+enum ClimatePreset : uint8_t {
+  CLIMATE_PRESET_NONE,
+  CLIMATE_PRESET_HOME,
+  CLIMATE_PRESET_AWAY,
+  CLIMATE_PRESET_BOOST,
+};
+enum ClimateAction : uint8_t {
+  CLIMATE_ACTION_OFF,
+  CLIMATE_ACTION_COOLING,
+  CLIMATE_ACTION_HEATING,
+};
+enum ClimateFeature : uint32_t {
+  CLIMATE_SUPPORTS_CURRENT_TEMPERATURE = 1 << 0,
+};
+
+class ClimateTraits {
+ public:
+  static inline uint32_t builds = 0;  // Calls to set_supported_modes(), process-wide
+
+  void add_feature_flags(uint32_t flags) { this->features_ |= flags; }
+  void set_visual_min_temperature(float value) { this->min_ = value; }
+  void set_visual_max_temperature(float value) { this->max_ = value; }
+  void set_visual_temperature_step(float value) { this->step_ = value; }
+  void set_supported_modes(std::initializer_list<ClimateMode> modes) {
+    builds++;
+    this->modes_ = mask_of(modes);
+  }
+  void set_supported_fan_modes(std::initializer_list<ClimateFanMode> modes) { this->fan_modes_ = mask_of(modes); }
+  void set_supported_swing_modes(std::initializer_list<ClimateSwingMode> modes) {
+    this->swing_modes_ = mask_of(modes);
+  }
+  void add_supported_preset(ClimatePreset preset) { this->presets_ |= 1u << preset; }
+
+ protected:
+  template<typename T> static uint32_t mask_of(std::initializer_list<T> values) {
+    uint32_t mask = 0;
+    for (T value : values) {
+      mask |= 1u << value;
+    }
+    return mask;
+  }
+
+  uint32_t features_{0};
+  float min_{0}, max_{0}, step_{0};
+  uint32_t modes_{0}, fan_modes_{0}, swing_modes_{0}, presets_{0};
+};
+
+class ClimateCall {
+ public:
+  ClimateCall &set_mode(ClimateMode mode) {
+    this->mode_ = mode;
+    return *this;
+  }
+  ClimateCall &set_target_temperature(float temperature) {
+    this->target_temperature_ = temperature;
+    return *this;
+  }
+  const std::optional<ClimateMode> &get_mode() const { return this->mode_; }
+  const std::optional<ClimateFanMode> &get_fan_mode() const { return this->fan_mode_; }
+  const std::optional<ClimatePreset> &get_preset() const { return this->preset_; }
+  const std::optional<float> &get_target_temperature() const { return this->target_temperature_; }
+  const std::optional<ClimateSwingMode> &get_swing_mode() const { return this->swing_mode_; }
+
+ protected:
+  std::optional<ClimateMode> mode_;
+  std::optional<ClimateFanMode> fan_mode_;
+  std::optional<ClimatePreset> preset_;
+  std::optional<float> target_temperature_;
+  std::optional<ClimateSwingMode> swing_mode_;
+};
+
+class Climate {
+ public:
+  virtual ~Climate() = default;
+  virtual void control(const ClimateCall &call) = 0;
+  virtual ClimateTraits traits() = 0;
+
+  ClimateTraits get_traits() { return this->traits(); }
+  void publish_state() {
+    (void) this->get_traits();
+    this->publish_count++;
+  }
+
+  ClimateMode mode{CLIMATE_MODE_OFF};
+  float current_temperature{};
+  float target_temperature{};
+  std::optional<ClimateFanMode> fan_mode;
+  std::optional<ClimatePreset> preset;
+  ClimateSwingMode swing_mode{CLIMATE_SWING_OFF};
+  ClimateAction action{CLIMATE_ACTION_OFF};
+  uint32_t publish_count{0};
+};
+
+}  // namespace climate
+}  // namespace esphome
@@ -0,0 +1,23 @@
+#pragma once
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace sensor {
+
+class Sensor {
+ public:
+  void add_on_state_callback(std::function<void(float)> &&callback) { this->callback_ = std::move(callback); }
+  void publish_state(float state) {
+    this->state = state;
+    if (this->callback_) {
+      this->callback_(state);
+    }
+  }
+  float state{};
+
+ protected:
+  std::function<void(float)> callback_;
+};
+
+}  // namespace sensor
+}  // namespace esphome
@@ -0,0 +1,47 @@
+#pragma once
+// Host stub of the UART device: reads come from a byte stream the test sets
+// with feed(), writes are only counted.
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace uart {
+
+enum UARTParityOptions { UART_CONFIG_PARITY_NONE, UART_CONFIG_PARITY_EVEN, UART_CONFIG_PARITY_ODD };
+
+class UARTComponent {
+ public:
+  uint32_t get_baud_rate() const { return 4800; }
+};
+
+class UARTDevice {
+ public:
+  void feed(const uint8_t *data, size_t size) {
+    this->rx_data_ = data;
+    this->rx_size_ = size;
+    this->rx_pos_ = 0;
+  }
+  size_t get_tx_bytes() const { return this->tx_bytes_; }
+
+  int available() { return static_cast<int>(this->rx_size_ - this->rx_pos_); }
+  bool read_byte(uint8_t *byte) {
+    if (this->rx_pos_ >= this->rx_size_) {
+      return false;
+    }
+    *byte = this->rx_data_[this->rx_pos_++];
+    return true;
+  }
+  void write_array(const uint8_t *, size_t size) { this->tx_bytes_ += size; }
+  void check_uart_settings(uint32_t, uint8_t, UARTParityOptions, uint8_t) {}
+
+ protected:
+  UARTComponent uart_;
+  UARTComponent *parent_{&uart_};
+  const uint8_t *rx_data_{nullptr};
+  size_t rx_size_{0};
+  size_t rx_pos_{0};
+  size_t tx_bytes_{0};
+};
+
+}  // namespace uart
+}  // namespace esphome
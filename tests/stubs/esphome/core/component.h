@@ -0,0 +1,29 @@
+#pragma once
+// Host stub of the ESPHome component base classes. millis() is provided by
+// the test so it can drive time.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace esphome {
+
+uint32_t millis();
+
+class Component {
+ public:
+  virtual ~Component() = default;
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  void mark_failed() {}
+};
+
+class PollingComponent : public Component {
+ public:
+  virtual void update() = 0;
+  uint32_t get_update_interval() const { return 1000; }
+};
+
+}  // namespace esphome
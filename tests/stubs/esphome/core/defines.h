@@ -0,0 +1,2 @@
+#pragma once
+// Host stub: feature defines come from the test's compile definitions.